@@ -0,0 +1,141 @@
+/* Expression templates over 1D Kokkos::Views so chained vector updates run as ONE fused kernel.
+ * Without them every operation is its own parallel_for plus a temporary View, e.g.
+ *     z = a*x + b*y   ->  tmp1 = a*x; tmp2 = b*y; z = tmp1 + tmp2;   (3 kernels, 7 passes over memory)
+ * Here the right hand side only builds a small expression object, nothing is computed until it is
+ * assigned to a kexpr::Vec (one parallel_for) or reduced with kexpr::dot / kexpr::sum (one parallel_reduce),
+ * and each element is evaluated in registers, so no intermediate Views are allocated.
+ * Usage:
+ *     kexpr::Vec<double> x("x", n), y("y", n), z("z", n), w("w", n);  // or wrap an existing View: kexpr::Vec<double> v(view);
+ *     z = a*x + y*w;                // single fused parallel_for
+ *     double r = kexpr::dot(x, y+z); // single fused parallel_reduce
+ * Every vector in an expression must have the same length as the destination (dot: as each other), scalars
+ * broadcast. A mismatch is caught on the host before the kernel launches and calls Kokkos::abort.
+ * Assignments are elementwise, so z = z + x is safe (element i only reads element i).
+ * Copies: Vec b = a; shares a's View (shallow, like View), but b = a; copies the elements into b's View
+ * (deep, like any other expression assignment).
+ */
+#ifndef KOKKOS_EXPR_HPP
+#define KOKKOS_EXPR_HPP
+
+#include "Kokkos_Core.hpp"
+
+namespace kexpr {
+
+/* CRTP base, lets the operators below accept any expression node but nothing else */
+template <class E>
+struct Expr {
+    KOKKOS_INLINE_FUNCTION const E& self() const { return static_cast<const E&>(*this); }
+};
+
+/* A scalar operand, broadcast to every element */
+template <class T>
+struct Scalar : public Expr<Scalar<T>> {
+    using value_type = T;
+    T value;
+    explicit Scalar(T v) : value(v) {}
+    KOKKOS_INLINE_FUNCTION T operator()(int) const { return value; }
+    size_t size() const { return 0; } /* takes the size of whatever vector it is combined with */
+    bool matches(size_t) const { return true; }
+};
+
+/* Leaf vector, owns (a reference counted handle to) a View in the default memory space */
+template <class T>
+class Vec : public Expr<Vec<T>> {
+public:
+    using value_type = T;
+    using view_type = Kokkos::View<T*, Kokkos::DefaultExecutionSpace>;
+
+    Vec(const std::string& label, size_t n) : view_(label, n) {}
+    explicit Vec(const view_type& v) : view_(v) {}
+    Vec(const Vec& other) = default; /* shallow, like View, needed to capture in kernels */
+
+    KOKKOS_INLINE_FUNCTION T operator()(int i) const { return view_(i); }
+    size_t size() const { return view_.extent(0); }
+    bool matches(size_t n) const { return size() == n; }
+    const view_type& view() const { return view_; }
+
+    /* Evaluate the whole expression in one parallel_for */
+    template <class E>
+    Vec& operator=(const Expr<E>& expr)
+    {
+        const E e = expr.self();     /* copies of the handles, never capture this on the GPU */
+        const view_type v = view_;
+        if (!e.matches(size())) Kokkos::abort("kexpr: vector lengths in assignment do not match");
+        Kokkos::parallel_for("kexpr_assign", size(), KOKKOS_LAMBDA(int i) {
+            v(i) = e(i);
+        });
+        return *this;
+    }
+    /* z = x copies elements (deep), unlike copy construction */
+    Vec& operator=(const Vec& other) { return operator=<Vec>(other); }
+
+private:
+    view_type view_;
+};
+
+/* Elementwise binary operations */
+struct Add { template <class A, class B> KOKKOS_INLINE_FUNCTION static auto apply(A a, B b) { return a + b; } };
+struct Sub { template <class A, class B> KOKKOS_INLINE_FUNCTION static auto apply(A a, B b) { return a - b; } };
+struct Mul { template <class A, class B> KOKKOS_INLINE_FUNCTION static auto apply(A a, B b) { return a * b; } };
+struct Div { template <class A, class B> KOKKOS_INLINE_FUNCTION static auto apply(A a, B b) { return a / b; } };
+
+/* Interior node, operands are held by value so expressions built from temporaries never dangle */
+template <class L, class R, class Op>
+struct BinaryExpr : public Expr<BinaryExpr<L, R, Op>> {
+    using value_type = decltype(Op::apply(typename L::value_type(), typename R::value_type()));
+    L lhs;
+    R rhs;
+    BinaryExpr(const L& l, const R& r) : lhs(l), rhs(r) {}
+    KOKKOS_INLINE_FUNCTION value_type operator()(int i) const { return Op::apply(lhs(i), rhs(i)); }
+    size_t size() const { return lhs.size() > rhs.size() ? lhs.size() : rhs.size(); }
+    bool matches(size_t n) const { return lhs.matches(n) && rhs.matches(n); }
+};
+
+/* expr OP expr, scalar OP expr, expr OP scalar */
+#define KEXPR_BINARY_OPERATOR(op, Op)                                                             \
+template <class L, class R>                                                                       \
+BinaryExpr<L, R, Op> operator op(const Expr<L>& l, const Expr<R>& r)                               \
+{ return BinaryExpr<L, R, Op>(l.self(), r.self()); }                                              \
+template <class R>                                                                                \
+BinaryExpr<Scalar<typename R::value_type>, R, Op> operator op(typename R::value_type s, const Expr<R>& r) \
+{ return BinaryExpr<Scalar<typename R::value_type>, R, Op>(Scalar<typename R::value_type>(s), r.self()); } \
+template <class L>                                                                                \
+BinaryExpr<L, Scalar<typename L::value_type>, Op> operator op(const Expr<L>& l, typename L::value_type s) \
+{ return BinaryExpr<L, Scalar<typename L::value_type>, Op>(l.self(), Scalar<typename L::value_type>(s)); }
+
+KEXPR_BINARY_OPERATOR(+, Add)
+KEXPR_BINARY_OPERATOR(-, Sub)
+KEXPR_BINARY_OPERATOR(*, Mul)
+KEXPR_BINARY_OPERATOR(/, Div)
+#undef KEXPR_BINARY_OPERATOR
+
+/* Fused reductions, return types are spelled out since CUDA lambdas can't live in auto functions */
+template <class L, class R>
+typename BinaryExpr<L, R, Mul>::value_type dot(const Expr<L>& a, const Expr<R>& b)
+{
+    using value_type = typename BinaryExpr<L, R, Mul>::value_type;
+    const BinaryExpr<L, R, Mul> e(a.self(), b.self());
+    if (!e.matches(e.size())) Kokkos::abort("kexpr: dot operands have different lengths");
+    value_type result = 0;
+    Kokkos::parallel_reduce("kexpr_dot", e.size(), KOKKOS_LAMBDA(int i, value_type& update) {
+        update += e(i);
+    }, result);
+    return result;
+}
+
+template <class E>
+typename E::value_type sum(const Expr<E>& expr)
+{
+    using value_type = typename E::value_type;
+    const E e = expr.self();
+    if (!e.matches(e.size())) Kokkos::abort("kexpr: vector lengths in sum do not match");
+    value_type result = 0;
+    Kokkos::parallel_reduce("kexpr_sum", e.size(), KOKKOS_LAMBDA(int i, value_type& update) {
+        update += e(i);
+    }, result);
+    return result;
+}
+
+} // namespace kexpr
+
+#endif // KOKKOS_EXPR_HPP
@@ -0,0 +1,92 @@
+/* PROGRAM DESCRIPTION: Benchmarks fused (kokkos_expr.hpp expression templates) vs unfused vector kernels.
+ * Workload, per iteration:   z = a*x + b*y;   w = z + c;   r = dot(x, y+z);
+ * Unfused: one parallel_for/parallel_reduce per operation with temporary Views, the way the vectorAdd
+ * kernel in rocm-hip/hip-vec-add.cpp or the y/x updates in kokkos_mpi_cuda_mvdot.cpp are written.
+ * Fused: one kernel per assignment/reduction, no temporaries.
+ * Memory traffic counts each element read or written once (8 bytes for double):
+ *   unfused  tmp1=a*x (2) tmp2=b*y (2) z=tmp1+tmp2 (3) w=z+c (2) tmp3=y+z (3) dot(x,tmp3) (2) = 14 passes
+ *   fused    z=a*x+b*y (3) w=z+c (2) dot(x,y+z) (3)                                          =  8 passes
+ * HOW TO RUN: ./kokkos_fused_vec <vector-length> <iterations>
+ */
+#include "Kokkos_Core.hpp"
+#include "kokkos_expr.hpp"
+#include <iostream>
+#include <cmath>
+#include <stdlib.h>
+
+typedef Kokkos::View<double*, Kokkos::DefaultExecutionSpace> ViewVectorType;
+
+int main(int argc, char** argv)
+{
+    Kokkos::initialize(argc, argv);
+    int status = 0;
+    {   // start kokkos scope
+        const int N = (argc > 1) ? atoi(argv[1]) : 1 << 24; /* 16 million elements */
+        const int iterations = (argc > 2) ? atoi(argv[2]) : 100;
+        const double a = 2.0, b = 0.5, c = 1.0;
+        std::cout << "\nCurrent execution space: " <<
+        typeid(Kokkos::DefaultExecutionSpace).name() << "\n" << std::endl;
+
+        ViewVectorType x("x", N), y("y", N), z("z", N), w("w", N);
+        ViewVectorType tmp1("tmp1", N), tmp2("tmp2", N), tmp3("tmp3", N); /* unfused only */
+        Kokkos::parallel_for("init", N, KOKKOS_LAMBDA(int i) {
+            x(i) = 1.0 / (i + 1);
+            y(i) = 1.0;
+        });
+        Kokkos::fence();
+
+        /* Unfused: every operation is its own pass over memory */
+        double unfused_r = 0;
+        Kokkos::Timer timer;
+        for (int it = 0; it < iterations; ++it) {
+            Kokkos::parallel_for("ax", N, KOKKOS_LAMBDA(int i) { tmp1(i) = a * x(i); });
+            Kokkos::parallel_for("by", N, KOKKOS_LAMBDA(int i) { tmp2(i) = b * y(i); });
+            Kokkos::parallel_for("z", N, KOKKOS_LAMBDA(int i) { z(i) = tmp1(i) + tmp2(i); });
+            Kokkos::parallel_for("w", N, KOKKOS_LAMBDA(int i) { w(i) = z(i) + c; });
+            Kokkos::parallel_for("y+z", N, KOKKOS_LAMBDA(int i) { tmp3(i) = y(i) + z(i); });
+            Kokkos::parallel_reduce("dot", N, KOKKOS_LAMBDA(int i, double& update) {
+                update += x(i) * tmp3(i);
+            }, unfused_r);
+        }
+        Kokkos::fence();
+        const double unfused_t = timer.seconds();
+        const double unfused_w = kexpr::sum(kexpr::Vec<double>(w));
+
+        /* Fused: expression templates, one kernel per assignment */
+        kexpr::Vec<double> X(x), Y(y), Z(z), W(w);
+        Kokkos::deep_copy(z, 0.0);
+        Kokkos::deep_copy(w, 0.0);
+        double fused_r = 0;
+        timer.reset();
+        for (int it = 0; it < iterations; ++it) {
+            Z = a*X + b*Y;
+            W = Z + c;
+            fused_r = kexpr::dot(X, Y + Z);
+        }
+        Kokkos::fence();
+        const double fused_t = timer.seconds();
+        const double fused_w = kexpr::sum(W);
+
+        /* Check both versions computed the same thing */
+        const double tol = 1e-9 * std::abs(unfused_r) + 1e-9 * std::abs(unfused_w);
+        const bool passed = std::abs(unfused_r - fused_r) <= tol && std::abs(unfused_w - fused_w) <= tol;
+        std::cout << "Verification " << (passed ? "passed" : "FAILED") << ": dot unfused " << unfused_r
+                  << " fused " << fused_r << ", sum(w) unfused " << unfused_w << " fused " << fused_w << "\n";
+
+        /* report time and bandwidth, GB moved is what each version actually touches */
+        const double gb = 1e-9 * sizeof(double) * (double)N * iterations;
+        const double unfused_gb = 14 * gb, fused_gb = 8 * gb;
+        std::cout << "\nVersion" << ',' << "N" << ',' << "Iterations" << ',' << "Time-s" << ','
+                  << "GB-Moved" << ',' << "Bandwidth-GB/s" << '\n';
+        std::cout << "unfused" << ',' << N << ',' << iterations << ',' << unfused_t << ','
+                  << unfused_gb << ',' << unfused_gb / unfused_t << '\n';
+        std::cout << "fused" << ',' << N << ',' << iterations << ',' << fused_t << ','
+                  << fused_gb << ',' << fused_gb / fused_t << '\n';
+        std::cout << "\nMemory traffic saved: " << unfused_gb - fused_gb << " GB ("
+                  << 100.0 * (unfused_gb - fused_gb) / unfused_gb << "%), speedup "
+                  << unfused_t / fused_t << "x" << std::endl;
+        if (!passed) status = EXIT_FAILURE;
+    } // close kokkos scope
+    Kokkos::finalize();
+    return status;
+}
@@ -16,18 +16,19 @@ void calcAccuracy(double pi, double est)
     double acc = (temp/pi)*100; 
     cout << "\npercenterror: " << fixed << acc << endl; 
 }
-// Problem size
-static int N = 1e8; 
+// Problem size, override with ./kokkos_pi <N> 
+static long N = 1e8; 
 
 int main(int argc, char* argv[])
 { 
     Kokkos::initialize(argc, argv); 
+    if (argc > 1) N = atol(argv[1]); /* kokkos args are already stripped from argv */ 
     double est, sum = 0.0; 
     const double pi =  3.141592653589793; 
     double step = 1.0/(double) N; 
     Kokkos::Timer timer; 
     // Begin parallel section
-    Kokkos::parallel_reduce("compute_pi", N, [=] (const int i, double& update){
+    Kokkos::parallel_reduce("compute_pi", N, [=] (const long i, double& update){
            update += 4.0/(1.0+((i+0.5)*step) * ((i+0.5)*step)) ;
        },sum);
     est = step*sum; 
@@ -0,0 +1,364 @@
+/* PROGRAM DESCRIPTION: Strong/weak scaling sweep driver for the kokkos targets in this directory.
+ * Replaces the one-run-per-thread-count, paste-into-Program1_2_4_Results.xlsx workflow.
+ * For every (mpi ranks, kokkos threads) point the target is run --reps times. Metrics use the kernel time each
+ * target prints itself (pi "took", sort "Kokkos Sort Took", gol Execution-Time-ms, mvdot slowest rank's yAx), so
+ * process launch, MPI/Kokkos init and serial host setup don't hide the kernel's scaling. Whole-process wall time
+ * is kept as an extra CSV column.
+ * Strong scaling keeps the problem size fixed, weak scaling grows it with the worker count (ranks*threads):
+ *   kokkos_gol   dim       * sqrt(q)   (2D grid, cells per worker stay constant)
+ *   kokkos_mpi_cuda_mvdot  M, N * sqrt(q), P x Q = near-square factorization of the rank count
+ *   kokkos_pi    N         * q
+ *   kokkos_sort  size      * q
+ * where q = workers / baseline workers, the baseline being the smallest point in the sweep.
+ * Reported per point (relative to the baseline):
+ *   speedup     strong: T0/Tq            weak (scaled speedup): q*T0/Tq
+ *   efficiency  speedup / q
+ *   karp-flatt  experimentally determined serial fraction e = (1/speedup - 1/q) / (1 - 1/q)
+ * HOW TO RUN: ./kokkos_scaling <target> [--mode=strong|weak|both] [--threads=1,2,4,8] [--ranks=1,2,4]
+ *             [--reps=3] [--size=<base problem size>] [--bin-dir=.] [--mpirun=mpirun]
+ *             [--csv=scaling.csv] [--log=<file>] [--min-efficiency=<0..1>]
+ * --ranks only applies to kokkos_mpi_cuda_mvdot, the one target that splits its work across MPI ranks, and every
+ * mvdot run goes through `mpirun -np <ranks>`. The other targets would just start <ranks> copies of the full problem,
+ * so they only sweep threads. mvdot is hard-coded to Kokkos::Cuda, so --kokkos-num-threads has no effect and it only
+ * sweeps ranks.
+ * --log appends every child's output to a file, it is discarded by default.
+ * --min-efficiency makes the driver exit non-zero if any point falls below it, so kernel changes
+ * that break scaling can be caught automatically.
+ */
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <chrono>  // timer
+#include <stdlib.h>
+
+struct Options {
+    std::string target;
+    std::string mode = "both";
+    std::vector<int> threads = {1, 2, 4, 8};
+    std::vector<int> ranks = {1};
+    bool use_mpirun = false;
+    int reps = 3;
+    long base_size = 0; /* 0 = per-target default */
+    std::string bin_dir = ".";
+    std::string mpirun = "mpirun";
+    std::string csv = "scaling.csv";
+    std::string log; /* targets like gol print the whole grid, so child output is only kept on request */
+    double min_efficiency = 0.0;
+};
+
+/* One (mode, ranks, threads) measurement and the metrics derived from it */
+struct Point {
+    std::string mode;
+    int ranks, threads, workers;
+    std::string args;
+    double t_min, t_mean, t_max; /* kernel seconds reported by the target */
+    double wall_mean;            /* whole process, including launch and setup */
+    double speedup, efficiency, karp_flatt; /* karp_flatt is NaN at the baseline */
+};
+
+void usage(const char* exe);
+std::vector<int> parseList(const std::string& list);
+long defaultSize(const std::string& target);
+std::string targetArgs(const std::string& target, long base, double q, int ranks);
+struct RunTime { double kernel, wall; };
+RunTime timeRun(const std::string& cmd, const std::string& target, const std::string& log);
+double parseKernelSeconds(const std::string& target, const std::string& line, bool& after_header);
+double parseNumber(const char* text);
+void computeMetrics(std::vector<Point>& points);
+void writeCsv(const Options& opt, const std::vector<Point>& points);
+void showSummary(const Options& opt, const std::vector<Point>& points);
+
+int main(int argc, char** argv)
+{
+    if (argc < 2) usage(argv[0]);
+    Options opt;
+    opt.target = argv[1];
+    bool threads_given = false, ranks_given = false;
+    for (int i = 2; i < argc; ++i) {
+        std::string arg = argv[i];
+        size_t eq = arg.find('=');
+        std::string key = arg.substr(0, eq);
+        std::string val = (eq == std::string::npos) ? "" : arg.substr(eq + 1);
+        if (key == "--mode") opt.mode = val;
+        else if (key == "--threads") { opt.threads = parseList(val); threads_given = true; }
+        else if (key == "--ranks") { opt.ranks = parseList(val); ranks_given = true; }
+        else if (key == "--reps") opt.reps = atoi(val.c_str());
+        else if (key == "--size") opt.base_size = atol(val.c_str());
+        else if (key == "--bin-dir") opt.bin_dir = val;
+        else if (key == "--mpirun") opt.mpirun = val;
+        else if (key == "--csv") opt.csv = val;
+        else if (key == "--log") opt.log = val;
+        else if (key == "--min-efficiency") opt.min_efficiency = atof(val.c_str());
+        else usage(argv[0]);
+    }
+    if (opt.target == "kokkos_mpi_cuda_mvdot") {
+        opt.use_mpirun = true; /* calls MPI_Init */
+        if (threads_given && (opt.threads.size() != 1 || opt.threads[0] != 1))
+            std::cout << "kokkos_mpi_cuda_mvdot runs on Kokkos::Cuda, ignoring --threads and sweeping ranks only\n";
+        opt.threads = {1};
+    } else {
+        if (ranks_given && (opt.ranks.size() != 1 || opt.ranks[0] != 1))
+            std::cout << opt.target << " does not split work across MPI ranks, ignoring --ranks and sweeping threads only\n";
+        opt.ranks = {1};
+    }
+    if (opt.base_size == 0) opt.base_size = defaultSize(opt.target);
+    if (opt.base_size <= 0 || opt.reps < 1 || opt.threads.empty() || opt.ranks.empty() ||
+        (opt.mode != "strong" && opt.mode != "weak" && opt.mode != "both"))
+        usage(argv[0]);
+
+    /* smallest worker count in the sweep is the baseline every other point is compared against */
+    int base_workers = 0;
+    for (int r : opt.ranks)
+        for (int t : opt.threads)
+            if (base_workers == 0 || r * t < base_workers) base_workers = r * t;
+
+    std::vector<std::string> modes;
+    if (opt.mode != "weak") modes.push_back("strong");
+    if (opt.mode != "strong") modes.push_back("weak");
+
+    std::vector<Point> points;
+    for (const std::string& mode : modes) {
+        for (int r : opt.ranks) {
+            for (int t : opt.threads) {
+                Point p;
+                p.mode = mode;
+                p.ranks = r;
+                p.threads = t;
+                p.workers = r * t;
+                double q = (mode == "weak") ? (double)p.workers / base_workers : 1.0;
+                p.args = targetArgs(opt.target, opt.base_size, q, r);
+
+                std::ostringstream cmd;
+                if (opt.use_mpirun) cmd << opt.mpirun << " -np " << r << " ";
+                cmd << opt.bin_dir << "/" << opt.target << " " << p.args
+                    << " --kokkos-num-threads=" << t << " 2>&1";
+
+                std::vector<double> times;
+                double wall = 0;
+                for (int rep = 0; rep < opt.reps; ++rep) {
+                    std::cout << "\r" << mode << " ranks=" << r << " threads=" << t
+                              << " rep " << rep + 1 << "/" << opt.reps << "   " << std::flush;
+                    RunTime rt = timeRun(cmd.str(), opt.target, opt.log);
+                    times.push_back(rt.kernel);
+                    wall += rt.wall;
+                }
+                p.t_min = *std::min_element(times.begin(), times.end());
+                p.t_max = *std::max_element(times.begin(), times.end());
+                p.t_mean = 0;
+                for (double s : times) p.t_mean += s;
+                p.t_mean /= times.size();
+                p.wall_mean = wall / times.size();
+                points.push_back(p);
+            }
+        }
+    }
+    std::cout << "\r" << std::string(60, ' ') << "\r";
+
+    computeMetrics(points);
+    writeCsv(opt, points);
+    showSummary(opt, points);
+
+    for (const Point& p : points) {
+        if (!(p.efficiency >= opt.min_efficiency)) { /* written so NaN/inf metrics fail too */
+            std::cerr << "Scaling regression: " << p.mode << " efficiency " << p.efficiency
+                      << " at " << p.workers << " workers is below --min-efficiency="
+                      << opt.min_efficiency << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+    return 0;
+}
+
+void usage(const char* exe)
+{
+    std::cerr << "Usage: " << exe << " <kokkos_gol|kokkos_mpi_cuda_mvdot|kokkos_pi|kokkos_sort>"
+              << " [--mode=strong|weak|both] [--threads=1,2,4,8] [--ranks=1,2,4] [--reps=3]"
+              << " [--size=<base problem size>] [--bin-dir=.] [--mpirun=mpirun] [--csv=scaling.csv]"
+              << " [--log=<file>] [--min-efficiency=<0..1>]" << std::endl;
+    exit(EXIT_FAILURE);
+}
+
+/* "1,2,4" -> {1, 2, 4}, ignoring anything that is not a positive count */
+std::vector<int> parseList(const std::string& list)
+{
+    std::vector<int> values;
+    std::stringstream ss(list);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        int v = atoi(item.c_str());
+        if (v > 0) values.push_back(v);
+    }
+    return values;
+}
+
+/* Same problem sizes the targets use when run without arguments */
+long defaultSize(const std::string& target)
+{
+    if (target == "kokkos_gol") return 512;
+    if (target == "kokkos_mpi_cuda_mvdot") return 1000;
+    if (target == "kokkos_pi") return 100000000;
+    if (target == "kokkos_sort") return 100000;
+    std::cerr << "Unknown target: " << target << std::endl;
+    exit(EXIT_FAILURE);
+}
+
+/* Command line problem size for the target, scaled by q (q = 1 for strong scaling) */
+std::string targetArgs(const std::string& target, long base, double q, int ranks)
+{
+    std::ostringstream args;
+    if (target == "kokkos_gol") {
+        args << std::lround(base * std::sqrt(q));
+    } else if (target == "kokkos_mpi_cuda_mvdot") {
+        int P = (int)std::sqrt((double)ranks);
+        while (ranks % P != 0) --P;
+        long dim = std::lround(base * std::sqrt(q));
+        args << dim << " " << dim << " " << P << " " << ranks / P;
+    } else {
+        args << std::lround(base * q);
+    }
+    return args.str();
+}
+
+/* Runs cmd once, returns the kernel seconds parsed from its output and the whole-process wall seconds */
+RunTime timeRun(const std::string& cmd, const std::string& target, const std::string& log)
+{
+    std::ofstream log_file;
+    if (!log.empty()) log_file.open(log, std::ios::app);
+    auto start = std::chrono::high_resolution_clock::now();
+    FILE* pipe = popen(cmd.c_str(), "r");
+    if (pipe == nullptr) {
+        std::cerr << "\nCould not run: " << cmd << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    /* read line by line, gol lines can be as long as the grid so fgets chunks are joined */
+    double kernel = -1;
+    bool after_header = false, invalid = false;
+    std::string line, bad_line;
+    char buf[4096];
+    auto parseLine = [&]() {
+        double seconds = parseKernelSeconds(target, line, after_header);
+        if (seconds == -1) return;
+        if (!(seconds > 0)) { invalid = true; bad_line = line; } /* 0 or unparsable, can't compute speedup from it */
+        else kernel = std::max(kernel, seconds); /* mvdot prints one yAx per rank, the slowest is the time to solution */
+    };
+    while (fgets(buf, sizeof(buf), pipe) != nullptr) {
+        line += buf;
+        if (line.back() != '\n') continue;
+        if (log_file) log_file << line;
+        parseLine();
+        line.clear();
+    }
+    if (!line.empty()) parseLine();
+    int status = pclose(pipe);
+    auto end = std::chrono::high_resolution_clock::now();
+    if (status != 0) {
+        std::cerr << "\nCommand failed (status " << status << "): " << cmd << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    if (invalid) {
+        std::cerr << "\nKernel time is zero or not a number (raise --size if the kernel is too short to time) in: "
+                  << bad_line << "from: " << cmd << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    if (kernel <= 0) {
+        std::cerr << "\nNo kernel time found in the output of: " << cmd << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    std::chrono::duration<double> wall = end - start;
+    return RunTime{kernel, wall.count()};
+}
+
+/* Kernel time printed by each target, in seconds, -1 if this line doesn't carry it, NaN if it isn't a number */
+double parseKernelSeconds(const std::string& target, const std::string& line, bool& after_header)
+{
+    double seconds = -1;
+    size_t pos;
+    if (target == "kokkos_pi" && (pos = line.find(" took ")) != std::string::npos) {
+        seconds = parseNumber(line.c_str() + pos + 6);
+    } else if (target == "kokkos_sort" && (pos = line.find("Sort Took: ")) != std::string::npos) {
+        seconds = parseNumber(line.c_str() + pos + 11) / 1000.0;
+    } else if (target == "kokkos_mpi_cuda_mvdot" && line.compare(0, 5, "yAx: ") == 0) {
+        seconds = parseNumber(line.c_str() + 5);
+    } else if (target == "kokkos_gol") {
+        /* Filename,Grid-Size,Execution-Time-ms,... header, then the values on the next line */
+        if (after_header) {
+            after_header = false;
+            std::stringstream ss(line);
+            std::string field;
+            for (int f = 0; f < 3 && std::getline(ss, field, ','); ++f) {}
+            seconds = parseNumber(field.c_str()) / 1000.0;
+        } else if (line.find("Execution-Time-ms") != std::string::npos) {
+            after_header = true;
+        }
+    }
+    return seconds;
+}
+
+/* strtod that reports NaN instead of 0 when there is no number to read */
+double parseNumber(const char* text)
+{
+    char* end;
+    double value = strtod(text, &end);
+    return (end == text) ? NAN : value;
+}
+
+/* Speedup, parallel efficiency and Karp-Flatt serial fraction of every point's kernel time against its mode's baseline */
+void computeMetrics(std::vector<Point>& points)
+{
+    for (Point& p : points) {
+        const Point* base = nullptr;
+        for (const Point& b : points)
+            if (b.mode == p.mode && (base == nullptr || b.workers < base->workers)) base = &b;
+        double q = (double)p.workers / base->workers;
+        double ratio = base->t_mean / p.t_mean;
+        p.speedup = (p.mode == "weak") ? q * ratio : ratio;
+        p.efficiency = p.speedup / q;
+        p.karp_flatt = (q > 1.0) ? (1.0 / p.speedup - 1.0 / q) / (1.0 - 1.0 / q) : NAN;
+    }
+}
+
+void writeCsv(const Options& opt, const std::vector<Point>& points)
+{
+    std::ofstream out(opt.csv);
+    if (!out) {
+        std::cerr << "Could not open " << opt.csv << " for writing" << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    out << "Target,Mode,Ranks,Threads,Workers,Args,Reps,Kernel-Min-s,Kernel-Mean-s,Kernel-Max-s,Wall-Mean-s,"
+        << "Speedup,Efficiency,Karp-Flatt\n";
+    for (const Point& p : points) {
+        out << opt.target << ',' << p.mode << ',' << p.ranks << ',' << p.threads << ','
+            << p.workers << ',' << p.args << ',' << opt.reps << ',' << p.t_min << ','
+            << p.t_mean << ',' << p.t_max << ',' << p.wall_mean << ',' << p.speedup << ',' << p.efficiency << ',';
+        if (!std::isnan(p.karp_flatt)) out << p.karp_flatt;
+        out << '\n';
+    }
+}
+
+void showSummary(const Options& opt, const std::vector<Point>& points)
+{
+    std::cout << "\nScaling summary for " << opt.target << " (" << opt.reps
+              << " reps per point, results in " << opt.csv << ")\n";
+    std::cout << std::left << std::setw(8) << "mode" << std::right << std::setw(7) << "ranks"
+              << std::setw(9) << "threads" << std::setw(9) << "workers" << "  " << std::left
+              << std::setw(24) << "args" << std::right << std::setw(12) << "kernel(s)" << std::setw(10) << "wall(s)"
+              << std::setw(10) << "speedup" << std::setw(8) << "eff" << std::setw(12)
+              << "karp-flatt" << "\n";
+    std::cout << std::fixed;
+    for (const Point& p : points) {
+        std::cout << std::left << std::setw(8) << p.mode << std::right << std::setw(7) << p.ranks
+                  << std::setw(9) << p.threads << std::setw(9) << p.workers << "  " << std::left
+                  << std::setw(24) << p.args << std::right << std::setprecision(4) << std::setw(12)
+                  << p.t_mean << std::setw(10) << p.wall_mean << std::setprecision(2) << std::setw(10) << p.speedup
+                  << std::setw(8) << p.efficiency << std::setw(12);
+        if (std::isnan(p.karp_flatt)) std::cout << "-";
+        else std::cout << std::setprecision(4) << p.karp_flatt;
+        std::cout << "\n";
+    }
+    std::cout << std::endl;
+}
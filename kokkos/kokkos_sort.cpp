@@ -15,12 +15,13 @@ void printVector(LinearType::HostMirror vec);
 void merge(LinearType ,int, int , int ); 
 void merge_sort(LinearType arr, int low, int high);
 
-int main()
+int main(int argc, char** argv)
 {
-    Kokkos::initialize();
+    Kokkos::initialize(argc, argv); /* forwards --kokkos-num-threads etc. */ 
     {
-        // Size of data to sort
+        // Size of data to sort, override with ./kokkos_sort <size> 
         int global_m = 100000;  
+        if (argc > 1) global_m = atoi(argv[1]); 
         // Init view with random values
          LinearType A("A", global_m); /*for test 1*/ 
          LinearType::HostMirror h_A = Kokkos::create_mirror_view(A); 